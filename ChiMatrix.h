@@ -0,0 +1,138 @@
+//Shared chi2 matrix container used by Normalize, Plotter, Comparion and Filter
+//Build : g++ -O3 -march=native -std=c++17 -fPIC -shared ChiMatrix.C -o libChiMatrix.so
+//   or : compile ChiMatrix.C together with the tool (see README)
+#ifndef CHIMATRIX_H
+#define CHIMATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// ------------------------------------
+// Binary layout (little endian, every section 8-byte aligned)
+//
+//   ChiMatrixHeader
+//   double   x[nData]               x-grid (only if CHIM_HAS_X)
+//   uint32_t nameIndex[nSets]       per-set index into the name table
+//   uint64_t nameOffset[nNames+1]   offsets of each name in the blob
+//   char     nameBlob[]             concatenated unique names
+//   double   values[nSets*nData]    one contiguous row per set
+// ------------------------------------
+const char     CHIM_MAGIC[8]  = {'M','C','T','C','H','I','2','\0'};
+const uint32_t CHIM_VERSION   = 1;
+const uint32_t CHIM_HAS_X     = 1u << 0;
+const uint32_t CHIM_HAS_NAMES = 1u << 1;
+
+struct ChiMatrixHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t nSets;
+    uint64_t nData;
+    uint64_t nNames;
+    uint64_t xOffset;
+    uint64_t nameIndexOffset;
+    uint64_t nameOffsetsOffset;
+    uint64_t nameBlobOffset;
+    uint64_t valuesOffset;
+    uint64_t fileSize;
+};
+
+// ------------------------------------
+// nSets x nData matrix of chi2 (or normalized) values
+// with an optional x-grid and interned histogram names.
+// Values either live in owned memory or in a read-only
+// file mapping (copy-on-write if modified).
+// ------------------------------------
+class ChiMatrix
+{
+public:
+    ChiMatrix();
+    ~ChiMatrix();
+
+    ChiMatrix(ChiMatrix&& other) noexcept;
+    ChiMatrix& operator=(ChiMatrix&& other) noexcept;
+    ChiMatrix(const ChiMatrix& other);
+    ChiMatrix& operator=(const ChiMatrix& other);
+
+    // -------- shape / storage --------
+    void   resize(size_t nSets, size_t nData, double fill = 0.0);
+    void   clear();
+    size_t nSets() const { return m_nSets; }
+    size_t nData() const { return m_nData; }
+    bool   empty() const { return m_nSets == 0 || m_nData == 0; }
+    bool   isMapped() const { return m_map != nullptr; }
+
+    const double* row(size_t i) const { return m_values + i*m_nData; }
+    double*       row(size_t i)       { return m_values + i*m_nData; }
+    const double* data() const { return m_values; }
+    double*       data()       { return m_values; }
+
+    double  operator()(size_t i, size_t j) const { return m_values[i*m_nData + j]; }
+    double& operator()(size_t i, size_t j)       { return m_values[i*m_nData + j]; }
+
+    // -------- x-grid --------
+    bool hasX() const { return !m_x.empty(); }
+    const std::vector<double>& x() const { return m_x; }
+    void setX(const std::vector<double>& x) { m_x = x; }
+
+    // -------- interned names --------
+    bool hasNames() const { return !m_nameIndex.empty(); }
+    const std::string& name(size_t i) const { return m_names[m_nameIndex[i]]; }
+    void setName(size_t i, const std::string& name);
+    bool setNames(const std::vector<std::string>& names);
+    std::vector<std::string> names() const;
+
+    // -------- select / append rows --------
+    ChiMatrix selectRows(const std::vector<size_t>& rows) const;
+
+    // -------- file access (used by the readers/writers) --------
+    bool mapFile(const std::string& filename);
+    const std::vector<std::string>& nameTable() const { return m_names; }
+    const std::vector<uint32_t>&    nameIndex() const { return m_nameIndex; }
+
+private:
+    void releaseMap();
+    uint32_t internName(const std::string& name);
+
+    size_t m_nSets;
+    size_t m_nData;
+
+    std::vector<double> m_owned;
+    double* m_values;
+
+    void*  m_map;
+    size_t m_mapSize;
+
+    std::vector<double> m_x;
+
+    std::vector<std::string> m_names;
+    std::vector<uint32_t>    m_nameIndex;
+    std::unordered_map<std::string, uint32_t> m_nameLookup;
+};
+
+// -------- reading (binary detected by magic, otherwise text) --------
+bool isChiMatrixBinary(const std::string& filename);
+bool readChiMatrix(const std::string& filename, ChiMatrix& m);
+bool readChiMatrixBinary(const std::string& filename, ChiMatrix& m);
+bool readChiMatrixText(const std::string& filename, ChiMatrix& m);
+
+// -------- writing (binary if the name ends with .chi2m) --------
+bool isChiMatrixBinaryName(const std::string& filename);
+bool writeChiMatrix(const std::string& filename, const ChiMatrix& m, bool textHeader = false);
+bool writeChiMatrixBinary(const std::string& filename, const ChiMatrix& m);
+bool writeChiMatrixText(const std::string& filename, const ChiMatrix& m, bool withHeader);
+
+// -------- names and x-values --------
+std::string cleanName(const std::string& name);        // "/ANA/d01-x01-y01.pdf" -> "d01-x01-y01"
+std::string extractHistID(std::string name);           // same, also strips ".pdf.pdf" and spaces
+std::string safeFileName(std::string name);            // "/ANA/d01-x01-y01.pdf" -> "ANA_d01-x01-y01"
+std::vector<std::string> readNamesFile(const std::string& filename);   // chi2_histo_values.txt
+std::vector<std::string> readNameList(const std::string& filename);    // refined_plots.txt
+bool writeNameList(const std::string& filename, const ChiMatrix& m);
+std::vector<double> readXValues(const std::string& filename);
+
+#endif
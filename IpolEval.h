@@ -0,0 +1,112 @@
+//Professor ipol.dat evaluation and chi2 scans, shared by ipolscan and mctune
+//Compile together with ChiMatrix.C, TuneCore.C and YodaFile.C (see README)
+#ifndef IPOLEVAL_H
+#define IPOLEVAL_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ChiMatrix.h"
+#include "YodaFile.h"
+
+// ------------------------------------
+// Polynomial parameterisation of every bin of an ipol.dat file.
+//
+// Coefficients are stored structure-of-arrays: coefficient c of all
+// bins is contiguous (coeff[c*stride + bin]), so one parameter point
+// is evaluated for many bins at once with SIMD. Monomials are ordered
+// by degree, and within a degree by descending power of the first
+// parameter (2D: 1, x, y, x^2, xy, y^2), so a lower order is a prefix
+// of a higher one and such bins are padded with zeros.
+// ------------------------------------
+class IpolModel
+{
+public:
+    IpolModel();
+
+    bool read(const std::string& filename);
+
+    // -------- parameters --------
+    size_t dim() const { return m_paramNames.size(); }
+    const std::vector<std::string>& paramNames() const { return m_paramNames; }
+    int    paramIndex(const std::string& name) const;
+    double minParam(size_t i) const { return m_minPV[i]; }
+    double maxParam(size_t i) const { return m_maxPV[i]; }
+
+    // -------- bins, grouped by histogram --------
+    size_t nBins() const { return m_binNumber.size(); }
+    size_t nHistos() const { return m_histoNames.size(); }
+    const std::string& histoName(size_t h) const { return m_histoNames[h]; }
+    size_t histoBegin(size_t h) const { return m_histoBegin[h]; }
+    size_t histoEnd(size_t h) const { return m_histoBegin[h+1]; }
+    int    binNumber(size_t b) const { return m_binNumber[b]; }
+
+    // -------- evaluation --------
+    // val/err must hold stride() doubles; params are unscaled
+    size_t stride() const { return m_stride; }
+    void   evaluate(const double* params, double* val, double* err) const;
+
+private:
+    void monomials(const double* params, std::vector<double>& mono) const;
+
+    std::vector<std::string> m_paramNames;
+    std::vector<double> m_minPV;
+    std::vector<double> m_maxPV;
+    bool m_scaled;
+
+    std::vector<std::string> m_histoNames;
+    std::vector<size_t> m_histoBegin;      // nHistos+1 entries
+    std::vector<int>    m_binNumber;
+
+    std::vector<std::vector<int>> m_exponents;   // per monomial
+    size_t m_stride;                       // nBins rounded up to the SIMD tile
+    size_t m_nValCoeff;
+    size_t m_nErrCoeff;
+    std::vector<double> m_val;             // [coeff][bin]
+    std::vector<double> m_err;
+};
+
+// -------- scan definition --------
+struct ScanParam
+{
+    std::string name;
+    double lo;
+    double hi;
+    int n;
+};
+
+struct FixedParam
+{
+    std::string name;
+    double value;
+};
+
+// ------------------------------------
+// Grid of parameter points, row-major (nPoints x dim).
+// One scanned parameter gives a line, two a grid (second one fastest);
+// all other parameters are fixed, by default at the centre of their range.
+// ------------------------------------
+bool makeScanPoints(const IpolModel& model, const std::vector<ScanParam>& scan,
+                    const std::vector<FixedParam>& fixed, std::vector<double>& points);
+
+// x-grid of a 1D scan (value of the scanned parameter per point); empty for a
+// 2D grid, whose row-major rows are not curves for the 1D refine/compare kernels
+std::vector<double> scanXValues(const IpolModel& model, const std::vector<ScanParam>& scan,
+                                const std::vector<double>& points);
+
+// "name lo hi n" per scanned parameter (shape of a 2D grid, last one fastest)
+bool writeScanGrid(const std::string& filename, const std::vector<ScanParam>& scan);
+
+bool writeScanPoints(const std::string& filename, const std::vector<std::string>& paramNames,
+                     const std::vector<double>& points);
+
+// ------------------------------------
+// chi2/n of every reference histogram with an interpolation at every
+// point (threads across points). Rows are named by histogram; rows
+// that cannot be compared at any point are dropped.
+// ------------------------------------
+bool ipolChi2Scan(const IpolModel& model, const HistoMap& ref,
+                  const std::vector<double>& points, int nThreads, ChiMatrix& m);
+
+#endif
@@ -0,0 +1,104 @@
+//Professor ipol.dat access shared by Filter and mctune
+//Compile together with ChiMatrix.C and TuneCore.C (see README)
+#ifndef IPOLFILE_H
+#define IPOLFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+// ------------------------------------
+// Histogram keys
+//   "/REF/ANA/d01-x01-y01#3" -> "ANA/d01-x01-y01"   (histoPathKey)
+//   "d01-x01-y01.pdf"        -> "d01-x01-y01"       (histoPathKey, no analysis)
+//   "ANA/d01-x01-y01"        -> "d01-x01-y01"       (histoBaseKey)
+// ------------------------------------
+std::string_view histoPathKey(std::string_view name);
+std::string_view histoBaseKey(std::string_view key);
+
+// ------------------------------------
+// Set of histograms to keep, hashed on the full analysis path.
+// Names without an analysis path (legacy refined lists) and the
+// basename-only mode fall back to matching on dXX-xXX-yXX.
+// ------------------------------------
+class HistoSelector
+{
+public:
+    HistoSelector() : m_basenameOnly(false) {}
+
+    void setBasenameOnly(bool b) { m_basenameOnly = b; }
+    void add(std::string_view name);
+    bool matches(std::string_view name) const;
+
+    size_t size() const { return m_paths.size() + m_basenames.size(); }
+    size_t nPaths() const { return m_paths.size(); }
+    size_t nBasenames() const { return m_basenames.size(); }
+
+private:
+    bool m_basenameOnly;
+    std::deque<std::string> m_storage;   // owns the strings the views point to
+    std::unordered_set<std::string_view> m_paths;
+    std::unordered_set<std::string_view> m_basenames;
+};
+
+// ------------------------------------
+// Record index of an ipol.dat file
+//   header : everything before the first record
+//   record : a line starting with '/' plus the following indented lines
+// The sidecar "<ipol>.idx" stores it so repeated filters skip the scan.
+// ------------------------------------
+const char     IPIX_MAGIC[8] = {'M','C','T','I','P','I','X','\0'};
+const uint32_t IPIX_VERSION  = 2;
+
+struct IpolIndexHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t fileSize;      // size / mtime (ns) of the indexed ipol file
+    int64_t  mtime;
+    uint64_t contentHash;   // hash of the first and last 4 KiB (same-size rewrites)
+    uint64_t headerEnd;
+    uint64_t headerLines;
+    uint64_t strayLines;    // non-record lines between records (dropped, counted in total)
+    uint64_t nRecords;
+    uint64_t namesSize;
+};
+
+struct IpolIndexRecord
+{
+    uint64_t offset;
+    uint64_t length;
+    uint64_t nameOffset;
+    uint32_t nameLength;
+    uint32_t nLines;
+};
+
+// -------- filter stage (Filter.C, mctune) --------
+struct FilterOptions
+{
+    int  nThreads;
+    bool useIndex;      // read/write the "<ipol>.idx" sidecar
+
+    FilterOptions() : nThreads(1), useIndex(false) {}
+};
+
+struct FilterStats
+{
+    long total;         // non-empty lines
+    long kept;
+    long records;
+    long keptRecords;
+    bool fromIndex;
+};
+
+std::string ipolIndexFile(const std::string& ipolFile);
+
+// copy the header and the records of inputDat selected by sel
+bool filterIpolFile(const std::string& inputDat, const std::string& outputDat,
+                    const HistoSelector& sel, const FilterOptions& opt, FilterStats& stats);
+
+#endif
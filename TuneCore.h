@@ -0,0 +1,185 @@
+//Pipeline stages shared by Normalize, Plotter, Comparion, Filter and mctune
+//Compile together with ChiMatrix.C (see README)
+#ifndef TUNECORE_H
+#define TUNECORE_H
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ChiMatrix.h"
+
+// ------------------------------------
+// Run fn(i) for i in [0,n) on nThreads workers
+// ------------------------------------
+template <class F>
+void parallelFor(size_t n, int nThreads, F fn)
+{
+    if (nThreads <= 1 || n <= 1) {
+        for (size_t i=0;i<n;i++) fn(i);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+
+    for (int t=0;t<nThreads && t<(int)n;t++) {
+        workers.emplace_back([&]() {
+            size_t i;
+            while ((i = next++) < n) fn(i);
+        });
+    }
+    for (auto& w : workers) w.join();
+}
+
+int defaultThreads();
+
+// -------- normalize stage (Normalize.C) --------
+enum NormMode
+{
+    NORM_LINEAR,   // 10 * (v - min) / (max - min)
+    NORM_LOG,      // 10 * log(1 + v - min) / log(1 + max - min)
+    NORM_RELMIN,   // v / min (sets with min <= 0 become missing)
+    NORM_ZSCORE    // (v - mean) / sd
+};
+
+bool parseNormMode(const std::string& name, NormMode& mode);
+
+// statistics of one set, NaN values (missing points) are ignored
+struct SetStats
+{
+    double min;
+    double max;
+    double mean;
+    double sd;
+    int    nValid;
+};
+
+SetStats computeSetStats(const double* v, int n);
+
+// rescale every set in place, returns the per-set statistics. Per set:
+// one SIMD statistics pass (min/max/mean/sd) and one SIMD scaling pass
+// over the row while it is still in cache; sets spread over nThreads
+std::vector<SetStats> normalizeMatrix(ChiMatrix& m, NormMode mode = NORM_LINEAR, int nThreads = 1);
+
+// -------- refine stage (Plotter.C --mode refined) --------
+int countMinima(const double* v, int n);
+std::vector<size_t> refinedRows(const ChiMatrix& m);
+
+// -------- curve-shape analysis --------
+struct ShapeOptions
+{
+    int    smoothWindow;    // moving-average window (odd, 1 = no smoothing)
+    double prominence;      // minimum depth of a smoothed minimum, as a fraction of max - min
+    int    fitHalfWidth;    // parabola fit uses the minimum +- fitHalfWidth points
+    double flatThreshold;   // flat region: y <= ymin + flatThreshold
+
+    ShapeOptions() : smoothWindow(3), prominence(0.05), fitHalfWidth(2), flatThreshold(1.0) {}
+};
+
+struct CurveShape
+{
+    int    nMinima;         // strict neighbour minima (countMinima)
+    int    nMinimaSmooth;   // minima of the smoothed curve with enough prominence
+    double xMin;            // fitted minimum position (grid point if the fit fails)
+    double xMinErr;         // its uncertainty from the fit covariance
+    double curvature;       // second derivative of the fitted parabola (sensitivity)
+    double flatWidth;       // x-width of the flat region around the minimum
+    double score;           // ranking score, 0 if not a single-minimum curve
+    bool   fitOk;
+};
+
+CurveShape analyzeCurve(const double* x, const double* y, int n, const ShapeOptions& opt);
+std::vector<CurveShape> analyzeMatrix(const ChiMatrix& m, const std::vector<double>& x,
+                                      const ShapeOptions& opt, int nThreads = 1);
+
+// indices sorted by descending score
+std::vector<size_t> rankCurves(const std::vector<CurveShape>& shapes);
+
+// -------- selection for refined mode / Filter --------
+struct SelectOptions
+{
+    bool   smooth;          // use nMinimaSmooth instead of the strict count
+    int    top;             // keep the best N (0 = all)
+    double minCurvature;    // keep curvature >= minCurvature
+    double maxFlatWidth;    // keep flatWidth <= maxFlatWidth (<= 0 = no cut)
+
+    SelectOptions() : smooth(false), top(0), minCurvature(0.0), maxFlatWidth(0.0) {}
+};
+
+// selected rows in their original order
+std::vector<size_t> selectCurves(const std::vector<CurveShape>& shapes, const SelectOptions& sel);
+
+// -------- ranked table --------
+// "# rank name nMinima nMinimaSmooth xMin xMinErr curvature flatWidth score"
+bool writeRankedTable(const std::string& filename, const ChiMatrix& m,
+                      const std::vector<CurveShape>& shapes);
+
+struct RankedEntry
+{
+    std::string name;
+    int    rank;
+    CurveShape shape;
+};
+
+bool isRankedTable(const std::string& filename);
+std::vector<RankedEntry> readRankedTable(const std::string& filename);
+std::vector<std::string> selectRanked(const std::vector<RankedEntry>& table, const SelectOptions& sel);
+
+// -------- compare stage (Comparion.C, mctune) --------
+// pairs (i,j) with namesA[i] == namesB[j], in the order of namesA
+std::vector<std::pair<int,int>> matchNames(const std::vector<std::string>& namesA,
+                                           const std::vector<std::string>& namesB);
+
+// one scan (tune, parameter, generator version) of an N-way comparison
+struct ScanCurves
+{
+    std::string label;
+    const ChiMatrix* data;      // named rows
+    std::vector<double> x;      // size data->nData()
+};
+
+struct CompareOptions
+{
+    int    nGrid;               // points of the common grid (0 = largest nData)
+    size_t minScans;            // keep histograms found in >= minScans scans (0 = all)
+    ShapeOptions shape;
+
+    CompareOptions() : nGrid(0), minScans(0) {}
+};
+
+struct CompareResult
+{
+    std::string name;
+    std::vector<int> rows;              // row per scan, -1 if missing
+    std::vector<CurveShape> shapes;     // per scan, on its own x-grid
+    int    nScans;                      // scans containing the histogram
+    double xMinMean;
+    double shift;                       // max - min of the minimum positions
+    double shiftSig;                    // shift / combined xMinErr of the two extremes
+    double sensRatio;                   // max / min curvature
+    double overlap;                     // |intersection| / |union| of the flat regions
+    double rms;                         // largest pairwise RMS difference
+};
+
+// overlap of all x ranges (their union if they do not overlap), nPoints equidistant points
+std::vector<double> commonGrid(const std::vector<ScanCurves>& scans, int nPoints);
+
+// linear interpolation of (x,y) at grid, NaN outside x or next to missing points
+void resampleCurve(const std::vector<double>& x, const double* y,
+                   const std::vector<double>& grid, double* out);
+
+// histograms joined by name over all scans (hashed), metrics computed on nThreads;
+// sorted by descending shift
+std::vector<CompareResult> compareScans(const std::vector<ScanCurves>& scans,
+                                        const std::vector<double>& grid,
+                                        const CompareOptions& opt, int nThreads = 1);
+
+// "# name nScans xMinMean shift shiftSig sensRatio overlap rms xMin_<label> curv_<label> ..."
+bool writeComparisonSummary(const std::string& filename, const std::vector<ScanCurves>& scans,
+                            const std::vector<CompareResult>& results);
+
+#endif
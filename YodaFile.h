@@ -0,0 +1,55 @@
+//YODA reference/MC reader shared by extract_chi2, ipolscan and mctune
+//Compile together with the tool (see README)
+#ifndef YODAFILE_H
+#define YODAFILE_H
+
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+// -------- one distribution (bin values + errors) --------
+struct Histo
+{
+    std::vector<double> y;
+    std::vector<double> errDn;
+    std::vector<double> errUp;
+};
+
+typedef std::map<std::string, Histo> HistoMap;
+
+// ------------------------------------
+// Map object path to a common key
+// "/REF/ANA/d01-x01-y01" and "/ANA/d01-x01-y01" -> "/ANA/d01-x01-y01"
+// returns "" for objects that are never compared (RAW, _EVTCOUNT, ...)
+// ------------------------------------
+std::string histoKey(std::string path);
+
+// ------------------------------------
+// Parse the 1D objects of a YODA file
+// Supports SCATTER2D, HISTO1D, PROFILE1D (V1/V2) and HISTO1D, PROFILE1D, ESTIMATE1D (V3)
+// ------------------------------------
+bool readYoda(const std::string& filename, HistoMap& histos);
+
+// ------------------------------------
+// chi2 of one bin; the reference error on the side of the MC value
+// is used. Returns false if the bin cannot be compared.
+// ------------------------------------
+inline bool binChi2(double ref, double refDn, double refUp,
+                    double mc, double mcDn, double mcUp, double& chi2)
+{
+    double diff = mc - ref;
+    double eRef = (diff > 0) ? refUp : refDn;
+    double eMC  = (diff > 0) ? mcDn  : mcUp;
+    double var  = eRef*eRef + eMC*eMC;
+
+    if (!(var > 0) || !std::isfinite(diff)) return false;
+
+    chi2 = diff*diff / var;
+    return true;
+}
+
+// chi2/n between reference and MC, NAN if no bin can be compared
+double computeChi2(const Histo& ref, const Histo& mc);
+
+#endif